@@ -32,6 +32,8 @@ xcopy /Y ..\..\performance\TcpEchoClient\bin\Release\*.* .
 xcopy /Y ..\..\performance\TcpEchoServer\bin\Release\*.* .
 xcopy /Y ..\..\performance\TcpMulticastClient\bin\Release\*.* .
 xcopy /Y ..\..\performance\TcpMulticastServer\bin\Release\*.* .
+xcopy /Y ..\..\performance\TcpZeroCopy\bin\Release\*.* .
+xcopy /Y ..\..\performance\TimerJitter\bin\Release\*.* .
 xcopy /Y ..\..\performance\UdpEchoClient\bin\Release\*.* .
 xcopy /Y ..\..\performance\UdpEchoServer\bin\Release\*.* .
 xcopy /Y ..\..\performance\UdpMulticastClient\bin\Release\*.* .
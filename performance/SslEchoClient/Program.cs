@@ -1,5 +1,7 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
 using System.Threading;
 using CSharpServer;
 using NDesk.Options;
@@ -29,6 +31,10 @@ namespace SslEchoClient
             _received += size;
             while (_received >= Program.MessageToSend.Length)
             {
+                // Round-trip latency of the oldest message in flight
+                lock (_timestamps)
+                    Latencies.Add(Stopwatch.GetTimestamp() - _timestamps.Dequeue());
+
                 SendMessage();
                 _received -= Program.MessageToSend.Length;
             }
@@ -45,9 +51,14 @@ namespace SslEchoClient
 
         private void SendMessage()
         {
+            lock (_timestamps)
+                _timestamps.Enqueue(Stopwatch.GetTimestamp());
             SendAsync(Program.MessageToSend);
         }
 
+        public List<long> Latencies = new List<long>();
+
+        private Queue<long> _timestamps = new Queue<long>();
         private long _sent;
         private long _received;
         private long _messages;
@@ -72,6 +83,14 @@ namespace SslEchoClient
             int messages = 1000;
             int size = 32;
             int seconds = 10;
+            bool quickack = false;
+            int timeout = 0;
+            long lowat = 0;
+            bool resume = false;
+            bool tls13 = false;
+            string ciphers = null;
+            string groups = null;
+            bool records = false;
 
             var options = new OptionSet()
             {
@@ -82,7 +101,15 @@ namespace SslEchoClient
                 { "c|clients=", v => clients = int.Parse(v) },
                 { "m|messages=", v => messages = int.Parse(v) },
                 { "s|size=", v => size = int.Parse(v) },
-                { "z|seconds=", v => seconds = int.Parse(v) }
+                { "z|seconds=", v => seconds = int.Parse(v) },
+                { "q|quickack", v => quickack = v != null },
+                { "u|timeout=", v => timeout = int.Parse(v) },
+                { "w|lowat=", v => lowat = long.Parse(v) },
+                { "r|resume", v => resume = v != null },
+                { "tls13", v => tls13 = v != null },
+                { "ciphers=", v => ciphers = v },
+                { "groups=", v => groups = v },
+                { "records", v => records = v != null }
             };
 
             try
@@ -111,6 +138,14 @@ namespace SslEchoClient
             Console.WriteLine($"Working messages: {messages}");
             Console.WriteLine($"Message size: {size}");
             Console.WriteLine($"Seconds to benchmarking: {seconds}");
+            Console.WriteLine($"Quick ACK: {quickack}");
+            Console.WriteLine($"User timeout: {timeout} ms");
+            Console.WriteLine($"Not sent low watermark: {lowat}");
+            Console.WriteLine($"Session resumption: {resume}");
+            Console.WriteLine($"Protocol: {(tls13 ? "TLS 1.3" : "TLS 1.2")}");
+            Console.WriteLine($"Ciphers: {ciphers ?? "default"}");
+            Console.WriteLine($"Groups: {groups ?? "default"}");
+            Console.WriteLine($"Dynamic record size: {records}");
 
             Console.WriteLine();
 
@@ -126,11 +161,24 @@ namespace SslEchoClient
             Console.WriteLine("Done!");
 
             // Create and prepare a new SSL client context
-            var context = new SslContext(SslMethod.TLSV12);
+            var context = new SslContext(tls13 ? SslMethod.TLS : SslMethod.TLSV12);
             context.SetDefaultVerifyPaths();
             context.SetRootCerts();
             context.SetVerifyMode(SslVerifyMode.VerifyPeer | SslVerifyMode.VerifyFailIfNoPeerCert);
             context.LoadVerifyFile("ca.pem");
+            context.SetupClientSessionCache(resume);
+            // Setup protocol version, ciphers and key exchange groups
+            if (tls13)
+                context.SetMinProtocolVersion(SslProtocolVersion.TLSV13);
+            if (ciphers != null)
+            {
+                if (tls13)
+                    context.SetCipherSuites(ciphers);
+                else
+                    context.SetCipherList(ciphers);
+            }
+            if (groups != null)
+                context.SetGroups(groups);
 
             // Create echo clients
             var echoClients = new List<EchoClient>();
@@ -138,6 +186,11 @@ namespace SslEchoClient
             {
                 var client = new EchoClient(service, context, address, port, messages);
                 // client.SetupNoDelay(true);
+                client.SetupQuickAck(quickack);
+                client.SetupUserTimeout(TimeSpan.FromMilliseconds(timeout));
+                client.SetupSendLowWatermark(lowat);
+                client.SetupSessionReuse(resume);
+                client.SetupDynamicRecordSize(records);
                 echoClients.Add(client);
             }
 
@@ -152,6 +205,8 @@ namespace SslEchoClient
                 while (!client.IsHandshaked)
                     Thread.Yield();
             Console.WriteLine("All clients connected!");
+            if (echoClients.Count > 0)
+                Console.WriteLine($"Negotiated: {echoClients[0].ProtocolVersion} {echoClients[0].Cipher}");
 
             // Wait for benchmarking
             Console.Write("Benchmarking...");
@@ -176,6 +231,8 @@ namespace SslEchoClient
             Console.WriteLine();
 
             Console.WriteLine($"Errors: {TotalErrors}");
+            Console.WriteLine($"Handshakes: {context.Handshakes}");
+            Console.WriteLine($"Resumed handshakes: {context.ResumedHandshakes}");
 
             Console.WriteLine();
 
@@ -190,6 +247,17 @@ namespace SslEchoClient
                 Console.WriteLine($"Message latency: {Service.GenerateTimePeriod((TimestampStop - TimestampStart).TotalMilliseconds / TotalMessages)}");
                 Console.WriteLine($"Message throughput: {(long)(TotalMessages / (TimestampStop - TimestampStart).TotalSeconds)} msg/s");
             }
+
+            // Round-trip latency percentiles
+            var latencies = echoClients.SelectMany(client => client.Latencies).OrderBy(latency => latency).ToList();
+            if (latencies.Count > 0)
+            {
+                Func<double, string> percentile = p => Service.GenerateTimePeriod(latencies[Math.Min((int)(p * latencies.Count), latencies.Count - 1)] * 1000.0 / Stopwatch.Frequency);
+                Console.WriteLine($"Round-trip latency p50: {percentile(0.5)}");
+                Console.WriteLine($"Round-trip latency p99: {percentile(0.99)}");
+                Console.WriteLine($"Round-trip latency p99.9: {percentile(0.999)}");
+                Console.WriteLine($"Round-trip latency max: {percentile(1.0)}");
+            }
         }
     }
 }
@@ -39,12 +39,36 @@ namespace SslEchoServer
             bool help = false;
             int port = 2222;
             int threads = Environment.ProcessorCount;
+            bool quickack = false;
+            int timeout = 0;
+            long lowat = 0;
+            long sessions = 20480;
+            bool tickets = false;
+            long handshakes = 0;
+            int handshakeTimeout = 0;
+            bool lowmem = false;
+            bool records = false;
+            bool tls13 = false;
+            string ciphers = null;
+            string groups = null;
 
             var options = new OptionSet()
             {
                 { "h|?|help",   v => help = v != null },
                 { "p|port=", v => port = int.Parse(v) },
-                { "t|threads=", v => threads = int.Parse(v) }
+                { "t|threads=", v => threads = int.Parse(v) },
+                { "q|quickack", v => quickack = v != null },
+                { "u|timeout=", v => timeout = int.Parse(v) },
+                { "w|lowat=", v => lowat = long.Parse(v) },
+                { "s|sessions=", v => sessions = long.Parse(v) },
+                { "k|tickets", v => tickets = v != null },
+                { "handshakes=", v => handshakes = long.Parse(v) },
+                { "handshake-timeout=", v => handshakeTimeout = int.Parse(v) },
+                { "l|lowmem", v => lowmem = v != null },
+                { "records", v => records = v != null },
+                { "tls13", v => tls13 = v != null },
+                { "ciphers=", v => ciphers = v },
+                { "groups=", v => groups = v }
             };
 
             try
@@ -68,6 +92,18 @@ namespace SslEchoServer
 
             Console.WriteLine($"Server port: {port}");
             Console.WriteLine($"Working threads: {threads}");
+            Console.WriteLine($"Quick ACK: {quickack}");
+            Console.WriteLine($"User timeout: {timeout} ms");
+            Console.WriteLine($"Not sent low watermark: {lowat}");
+            Console.WriteLine($"Session cache size: {sessions}");
+            Console.WriteLine($"Session tickets: {tickets}");
+            Console.WriteLine($"Maximal handshakes in progress: {handshakes}");
+            Console.WriteLine($"Handshake timeout: {handshakeTimeout} ms");
+            Console.WriteLine($"Low memory mode: {lowmem}");
+            Console.WriteLine($"Dynamic record size: {records}");
+            Console.WriteLine($"Protocol: {(tls13 ? "TLS 1.3" : "TLS 1.2")}");
+            Console.WriteLine($"Ciphers: {ciphers ?? "default"}");
+            Console.WriteLine($"Groups: {groups ?? "default"}");
 
             Console.WriteLine();
 
@@ -80,17 +116,40 @@ namespace SslEchoServer
             Console.WriteLine("Done!");
 
             // Create and prepare a new SSL server context
-            var context = new SslContext(SslMethod.TLSV12);
+            var context = new SslContext(tls13 ? SslMethod.TLS : SslMethod.TLSV12);
             context.SetPassword("qwerty");
             context.UseCertificateChainFile("server.pem");
             context.UsePrivateKeyFile("server.pem", SslFileFormat.PEM);
             context.UseTmpDHFile("dh4096.pem");
+            // Setup protocol version, ciphers and key exchange groups
+            if (tls13)
+                context.SetMinProtocolVersion(SslProtocolVersion.TLSV13);
+            if (ciphers != null)
+            {
+                if (tls13)
+                    context.SetCipherSuites(ciphers);
+                else
+                    context.SetCipherList(ciphers);
+            }
+            if (groups != null)
+                context.SetGroups(groups);
+            context.SetServerCipherPreference(ciphers != null);
+            context.SetupSessionCache(sessions, TimeSpan.FromMinutes(5));
+            // OpenSSL issues session tickets by default, so disable them explicitly
+            context.SetupSessionTickets(tickets, TimeSpan.FromMinutes(1));
 
             // Create a new echo server
             var server = new EchoServer(service, context, port, InternetProtocol.IPv4);
             // server.SetupNoDelay(true);
             server.SetupReuseAddress(true);
             server.SetupReusePort(true);
+            server.SetupQuickAck(quickack);
+            server.SetupUserTimeout(TimeSpan.FromMilliseconds(timeout));
+            server.SetupSendLowWatermark(lowat);
+            server.SetupMaxHandshakes(handshakes);
+            server.SetupHandshakeTimeout(TimeSpan.FromMilliseconds(handshakeTimeout));
+            server.SetupLowMemory(lowmem, TimeSpan.FromSeconds(5));
+            server.SetupDynamicRecordSize(records);
 
             // Start the server
             Console.Write("Server starting...");
@@ -120,6 +179,21 @@ namespace SslEchoServer
             server.Stop();
             Console.WriteLine("Done!");
 
+            Console.WriteLine();
+
+            Console.WriteLine($"Handshakes: {context.Handshakes}");
+            Console.WriteLine($"Full handshakes: {context.FullHandshakes}");
+            Console.WriteLine($"Resumed handshakes: {context.ResumedHandshakes}");
+            Console.WriteLine($"Resumption ratio: {context.ResumptionRatio:P1}");
+            Console.WriteLine($"Peak handshakes in progress: {server.HandshakesPeak}");
+            Console.WriteLine($"Rejected handshakes: {server.RejectedHandshakes}");
+            Console.WriteLine($"Handshake average time: {server.HandshakeAverageTime.TotalMilliseconds:F3} ms");
+            Console.WriteLine($"Handshake max time: {server.HandshakeMaxTime.TotalMilliseconds:F3} ms");
+            Console.WriteLine($"Handshake failures: aborted {server.HandshakeAborts}, protocol {server.HandshakeProtocolFailures}, certificate {server.HandshakeCertificateFailures}, timeout {server.HandshakeTimeouts}");
+            Console.WriteLine($"Idle buffer releases: {server.BufferReleases}");
+
+            Console.WriteLine();
+
             // Stop the service
             Console.Write("Service stopping...");
             service.Stop();
@@ -1,5 +1,7 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
 using System.Threading;
 using CSharpServer;
 using NDesk.Options;
@@ -29,6 +31,10 @@ namespace TcpEchoClient
             _received += size;
             while (_received >= Program.MessageToSend.Length)
             {
+                // Round-trip latency of the oldest message in flight
+                lock (_timestamps)
+                    Latencies.Add(Stopwatch.GetTimestamp() - _timestamps.Dequeue());
+
                 SendMessage();
                 _received -= Program.MessageToSend.Length;
             }
@@ -45,9 +51,14 @@ namespace TcpEchoClient
 
         private void SendMessage()
         {
+            lock (_timestamps)
+                _timestamps.Enqueue(Stopwatch.GetTimestamp());
             SendAsync(Program.MessageToSend);
         }
 
+        public List<long> Latencies = new List<long>();
+
+        private Queue<long> _timestamps = new Queue<long>();
         private long _sent;
         private long _received;
         private long _messages;
@@ -72,6 +83,9 @@ namespace TcpEchoClient
             int messages = 1000;
             int size = 32;
             int seconds = 10;
+            bool quickack = false;
+            int timeout = 0;
+            long lowat = 0;
 
             var options = new OptionSet()
             {
@@ -82,7 +96,10 @@ namespace TcpEchoClient
                 { "c|clients=", v => clients = int.Parse(v) },
                 { "m|messages=", v => messages = int.Parse(v) },
                 { "s|size=", v => size = int.Parse(v) },
-                { "z|seconds=", v => seconds = int.Parse(v) }
+                { "z|seconds=", v => seconds = int.Parse(v) },
+                { "q|quickack", v => quickack = v != null },
+                { "u|timeout=", v => timeout = int.Parse(v) },
+                { "w|lowat=", v => lowat = long.Parse(v) }
             };
 
             try
@@ -111,6 +128,9 @@ namespace TcpEchoClient
             Console.WriteLine($"Working messages: {messages}");
             Console.WriteLine($"Message size: {size}");
             Console.WriteLine($"Seconds to benchmarking: {seconds}");
+            Console.WriteLine($"Quick ACK: {quickack}");
+            Console.WriteLine($"User timeout: {timeout} ms");
+            Console.WriteLine($"Not sent low watermark: {lowat}");
 
             Console.WriteLine();
 
@@ -131,6 +151,9 @@ namespace TcpEchoClient
             {
                 var client = new EchoClient(service, address, port, messages);
                 // client.SetupNoDelay(true);
+                client.SetupQuickAck(quickack);
+                client.SetupUserTimeout(TimeSpan.FromMilliseconds(timeout));
+                client.SetupSendLowWatermark(lowat);
                 echoClients.Add(client);
             }
 
@@ -183,6 +206,17 @@ namespace TcpEchoClient
                 Console.WriteLine($"Message latency: {Service.GenerateTimePeriod((TimestampStop - TimestampStart).TotalMilliseconds / TotalMessages)}");
                 Console.WriteLine($"Message throughput: {(long)(TotalMessages / (TimestampStop - TimestampStart).TotalSeconds)} msg/s");
             }
+
+            // Round-trip latency percentiles
+            var latencies = echoClients.SelectMany(client => client.Latencies).OrderBy(latency => latency).ToList();
+            if (latencies.Count > 0)
+            {
+                Func<double, string> percentile = p => Service.GenerateTimePeriod(latencies[Math.Min((int)(p * latencies.Count), latencies.Count - 1)] * 1000.0 / Stopwatch.Frequency);
+                Console.WriteLine($"Round-trip latency p50: {percentile(0.5)}");
+                Console.WriteLine($"Round-trip latency p99: {percentile(0.99)}");
+                Console.WriteLine($"Round-trip latency p99.9: {percentile(0.999)}");
+                Console.WriteLine($"Round-trip latency max: {percentile(1.0)}");
+            }
         }
     }
 }
@@ -39,12 +39,18 @@ namespace TcpEchoServer
             bool help = false;
             int port = 1111;
             int threads = Environment.ProcessorCount;
+            bool quickack = false;
+            int timeout = 0;
+            long lowat = 0;
 
             var options = new OptionSet()
             {
                 { "h|?|help",   v => help = v != null },
                 { "p|port=", v => port = int.Parse(v) },
-                { "t|threads=", v => threads = int.Parse(v) }
+                { "t|threads=", v => threads = int.Parse(v) },
+                { "q|quickack", v => quickack = v != null },
+                { "u|timeout=", v => timeout = int.Parse(v) },
+                { "w|lowat=", v => lowat = long.Parse(v) }
             };
 
             try
@@ -68,6 +74,9 @@ namespace TcpEchoServer
 
             Console.WriteLine($"Server port: {port}");
             Console.WriteLine($"Working threads: {threads}");
+            Console.WriteLine($"Quick ACK: {quickack}");
+            Console.WriteLine($"User timeout: {timeout} ms");
+            Console.WriteLine($"Not sent low watermark: {lowat}");
 
             Console.WriteLine();
 
@@ -84,6 +93,9 @@ namespace TcpEchoServer
             // server.SetupNoDelay(true);
             server.SetupReuseAddress(true);
             server.SetupReusePort(true);
+            server.SetupQuickAck(quickack);
+            server.SetupUserTimeout(TimeSpan.FromMilliseconds(timeout));
+            server.SetupSendLowWatermark(lowat);
 
             // Start the server
             Console.Write("Server starting...");
@@ -0,0 +1,208 @@
+﻿using System;
+using System.Diagnostics;
+using System.Threading;
+using CSharpServer;
+using NDesk.Options;
+
+namespace TcpZeroCopy
+{
+    class SinkSession : TcpSession
+    {
+        public SinkSession(TcpServer server) : base(server) {}
+
+        protected override void OnReceived(byte[] buffer, long size)
+        {
+            Interlocked.Add(ref Program.TotalBytes, size);
+        }
+
+        protected override void OnError(int error, string category, string message)
+        {
+            Console.WriteLine($"Session caught an error with code {error} and category '{category}': {message}");
+        }
+    }
+
+    class SinkServer : TcpServer
+    {
+        public SinkServer(Service service, int port, InternetProtocol protocol) : base(service, port, protocol) {}
+
+        protected override TcpSession CreateSession() { return new SinkSession(this); }
+
+        protected override void OnError(int error, string category, string message)
+        {
+            Console.WriteLine($"Server caught an error with code {error} and category '{category}': {message}");
+        }
+    }
+
+    class SendClient : TcpClient
+    {
+        public SendClient(Service service, string address, int port, int size, int messages) : base(service, address, port)
+        {
+            _buffers = new byte[messages][];
+            for (int i = 0; i < messages; ++i)
+                _buffers[i] = new byte[size];
+        }
+
+        public bool Running { get; set; }
+
+        protected override void OnConnected()
+        {
+            Running = true;
+
+            // Keep all messages in flight
+            foreach (var buffer in _buffers)
+                SendAsync(buffer);
+        }
+
+        protected override void OnSent(long sent, long pending)
+        {
+            // In copy mode resend messages while the send buffer is drained
+            if (Running && (OptionZeroCopyThreshold == 0))
+                while (BytesPending < _buffers.Length * (long)_buffers[0].Length)
+                    SendAsync(_buffers[0]);
+        }
+
+        protected override void OnZeroCopySent(byte[] buffer)
+        {
+            // In zero-copy mode resend the returned message
+            if (Running)
+                SendAsync(buffer);
+        }
+
+        protected override void OnError(int error, string category, string message)
+        {
+            Console.WriteLine($"Client caught an error with code {error} and category '{category}': {message}");
+            ++Program.TotalErrors;
+        }
+
+        private byte[][] _buffers;
+    }
+
+    class Program
+    {
+        public static long TotalErrors;
+        public static long TotalBytes;
+
+        static void Main(string[] args)
+        {
+            bool help = false;
+            int port = 1111;
+            int threads = Environment.ProcessorCount;
+            int messages = 4;
+            int seconds = 5;
+
+            var options = new OptionSet()
+            {
+                { "h|?|help",   v => help = v != null },
+                { "p|port=", v => port = int.Parse(v) },
+                { "t|threads=", v => threads = int.Parse(v) },
+                { "m|messages=", v => messages = int.Parse(v) },
+                { "z|seconds=", v => seconds = int.Parse(v) }
+            };
+
+            try
+            {
+                options.Parse(args);
+            }
+            catch (OptionException e)
+            {
+                Console.Write("Command line error: ");
+                Console.WriteLine(e.Message);
+                Console.WriteLine("Try `--help' to get usage information.");
+                return;
+            }
+
+            if (help)
+            {
+                Console.WriteLine("Usage:");
+                options.WriteOptionDescriptions(Console.Out);
+                return;
+            }
+
+            Console.WriteLine($"Server port: {port}");
+            Console.WriteLine($"Working threads: {threads}");
+            Console.WriteLine($"Messages in flight: {messages}");
+            Console.WriteLine($"Seconds to benchmarking: {seconds}");
+
+            Console.WriteLine();
+
+            // Create a new service
+            var service = new Service(threads);
+
+            // Start the service
+            Console.Write("Service starting...");
+            service.Start();
+            Console.WriteLine("Done!");
+
+            // Create a new sink server
+            var server = new SinkServer(service, port, InternetProtocol.IPv4);
+
+            // Start the server
+            Console.Write("Server starting...");
+            server.Start();
+            Console.WriteLine("Done!");
+
+            Console.WriteLine();
+
+            foreach (int size in new[] { 64 * 1024, 256 * 1024, 1024 * 1024, 4 * 1024 * 1024 })
+            {
+                Benchmark(service, port, size, messages, seconds, false);
+                Benchmark(service, port, size, messages, seconds, true);
+            }
+
+            // Stop the server
+            Console.Write("Server stopping...");
+            server.Stop();
+            Console.WriteLine("Done!");
+
+            // Stop the service
+            Console.Write("Service stopping...");
+            service.Stop();
+            Console.WriteLine("Done!");
+
+            Console.WriteLine();
+
+            Console.WriteLine($"Errors: {TotalErrors}");
+        }
+
+        static void Benchmark(Service service, int port, int size, int messages, int seconds, bool zerocopy)
+        {
+            var client = new SendClient(service, "127.0.0.1", port, size, messages);
+            if (zerocopy)
+            {
+                // Send messages directly from the managed memory bypassing the socket send buffer
+                client.SetupZeroCopyThreshold(size);
+                client.SetupSendBufferSize(0);
+            }
+
+            Interlocked.Exchange(ref TotalBytes, 0);
+
+            var process = Process.GetCurrentProcess();
+            process.Refresh();
+            var cpuStart = process.TotalProcessorTime;
+            var timestampStart = DateTime.UtcNow;
+
+            client.ConnectAsync();
+            Thread.Sleep(seconds * 1000);
+            client.Running = false;
+
+            var timestampStop = DateTime.UtcNow;
+            process.Refresh();
+            var cpuStop = process.TotalProcessorTime;
+            long bytes = Interlocked.Read(ref TotalBytes);
+
+            client.DisconnectAsync();
+            while (client.IsConnected)
+                Thread.Yield();
+
+            double elapsed = (timestampStop - timestampStart).TotalSeconds;
+            double cpu = (cpuStop - cpuStart).TotalSeconds;
+
+            Console.WriteLine($"{(zerocopy ? "Zero-copy" : "Copy")} mode, message size: {Service.GenerateDataSize(size)}");
+            Console.WriteLine($"Data throughput: {Service.GenerateDataSize((long)(bytes / elapsed))}/s");
+            Console.WriteLine($"CPU usage: {(long)(100.0 * cpu / elapsed)}%");
+            if (bytes > 0)
+                Console.WriteLine($"CPU per GiB: {Service.GenerateTimePeriod(1000.0 * cpu * (1024.0 * 1024.0 * 1024.0) / bytes)}");
+            Console.WriteLine();
+        }
+    }
+}
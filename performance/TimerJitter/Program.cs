@@ -0,0 +1,223 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+using CSharpServer;
+using NDesk.Options;
+
+namespace TimerJitter
+{
+    class JitterTimer : Timer
+    {
+        public JitterTimer(Service service, TimeSpan interval, int samples) : base(service)
+        {
+            _interval = interval;
+            _latencies = new List<long>(samples);
+            _samples = samples;
+        }
+
+        public List<long> Latencies => _latencies;
+        public bool IsCompleted => _completed;
+
+        public void Start()
+        {
+            _timestamp = Stopwatch.GetTimestamp();
+            Setup(_interval);
+            WaitAsync();
+        }
+
+        protected override void OnTimer(bool canceled)
+        {
+            if (canceled)
+                return;
+
+            _latencies.Add(Program.Latency(_timestamp, _interval));
+
+            if (_latencies.Count < _samples)
+                Start();
+            else
+                _completed = true;
+        }
+
+        protected override void OnError(int error, string category, string message)
+        {
+            Console.WriteLine($"Timer caught an error with code {error} and category '{category}': {message}");
+            ++Program.TotalErrors;
+            _completed = true;
+        }
+
+        private TimeSpan _interval;
+        private List<long> _latencies;
+        private int _samples;
+        private long _timestamp;
+        private volatile bool _completed;
+    }
+
+    class JitterPrecisionTimer : PrecisionTimer
+    {
+        public JitterPrecisionTimer(Service service, TimeSpan interval, TimeSpan spin, int samples) : base(service)
+        {
+            _interval = interval;
+            _latencies = new List<long>(samples);
+            _samples = samples;
+            SetupSpin(spin);
+        }
+
+        public List<long> Latencies => _latencies;
+        public bool IsCompleted => _completed;
+
+        public void Start()
+        {
+            _timestamp = Stopwatch.GetTimestamp();
+            Setup(_interval);
+            WaitAsync();
+        }
+
+        protected override void OnTimer(bool canceled)
+        {
+            if (canceled)
+                return;
+
+            _latencies.Add(Program.Latency(_timestamp, _interval));
+
+            if (_latencies.Count < _samples)
+                Start();
+            else
+                _completed = true;
+        }
+
+        protected override void OnError(int error, string category, string message)
+        {
+            Console.WriteLine($"Precision timer caught an error with code {error} and category '{category}': {message}");
+            ++Program.TotalErrors;
+            _completed = true;
+        }
+
+        private TimeSpan _interval;
+        private List<long> _latencies;
+        private int _samples;
+        private long _timestamp;
+        private volatile bool _completed;
+    }
+
+    class Program
+    {
+        public static long TotalErrors;
+
+        // Wake-up latency in nanoseconds measured with the high resolution performance counter
+        public static long Latency(long timestamp, TimeSpan interval)
+        {
+            double elapsed = (Stopwatch.GetTimestamp() - timestamp) * 1000000000.0 / Stopwatch.Frequency;
+            return (long)elapsed - interval.Ticks * 100;
+        }
+
+        static void Main(string[] args)
+        {
+            bool help = false;
+            int interval = 500;
+            int spin = 0;
+            int samples = 10000;
+            bool precision = true;
+
+            var options = new OptionSet()
+            {
+                { "h|?|help",   v => help = v != null },
+                { "i|interval=", v => interval = int.Parse(v) },
+                { "s|spin=", v => spin = int.Parse(v) },
+                { "n|samples=", v => samples = int.Parse(v) },
+                { "r|regular", v => precision = v == null }
+            };
+
+            try
+            {
+                options.Parse(args);
+            }
+            catch (OptionException e)
+            {
+                Console.Write("Command line error: ");
+                Console.WriteLine(e.Message);
+                Console.WriteLine("Try `--help' to get usage information.");
+                return;
+            }
+
+            if (help)
+            {
+                Console.WriteLine("Usage:");
+                options.WriteOptionDescriptions(Console.Out);
+                return;
+            }
+
+            Console.WriteLine($"Timer: {(precision ? "precision" : "regular")}");
+            Console.WriteLine($"Timer interval: {interval} us");
+            if (precision)
+                Console.WriteLine($"Timer spin: {spin} us");
+            Console.WriteLine($"Timer samples: {samples}");
+
+            Console.WriteLine();
+
+            // Create a new service
+            var service = new Service();
+
+            // Start the service
+            Console.Write("Service starting...");
+            service.Start();
+            Console.WriteLine("Done!");
+
+            // Timer interval and spin are given in microseconds
+            var timespan = TimeSpan.FromTicks(interval * 10);
+            var spintime = TimeSpan.FromTicks(spin * 10);
+
+            List<long> latencies;
+
+            Console.Write("Benchmarking...");
+            if (precision)
+            {
+                var timer = new JitterPrecisionTimer(service, timespan, spintime, samples);
+                Console.Write(timer.IsHighResolution ? "(high resolution)..." : "(low resolution)...");
+                timer.Start();
+                while (!timer.IsCompleted)
+                    Thread.Sleep(100);
+                latencies = timer.Latencies;
+            }
+            else
+            {
+                var timer = new JitterTimer(service, timespan, samples);
+                timer.Start();
+                while (!timer.IsCompleted)
+                    Thread.Sleep(100);
+                latencies = timer.Latencies;
+            }
+            Console.WriteLine("Done!");
+
+            // Stop the service
+            Console.Write("Service stopping...");
+            service.Stop();
+            Console.WriteLine("Done!");
+
+            Console.WriteLine();
+
+            Console.WriteLine($"Errors: {TotalErrors}");
+
+            Console.WriteLine();
+
+            if (latencies.Count == 0)
+                return;
+
+            latencies.Sort();
+
+            Console.WriteLine($"Total samples: {latencies.Count}");
+            Console.WriteLine($"Wake-up latency min: {Service.GenerateTimePeriod(latencies[0] / 1000000.0)}");
+            Console.WriteLine($"Wake-up latency p50: {Service.GenerateTimePeriod(Percentile(latencies, 50.0) / 1000000.0)}");
+            Console.WriteLine($"Wake-up latency p90: {Service.GenerateTimePeriod(Percentile(latencies, 90.0) / 1000000.0)}");
+            Console.WriteLine($"Wake-up latency p99: {Service.GenerateTimePeriod(Percentile(latencies, 99.0) / 1000000.0)}");
+            Console.WriteLine($"Wake-up latency p99.9: {Service.GenerateTimePeriod(Percentile(latencies, 99.9) / 1000000.0)}");
+            Console.WriteLine($"Wake-up latency max: {Service.GenerateTimePeriod(latencies[latencies.Count - 1] / 1000000.0)}");
+        }
+
+        static long Percentile(List<long> sorted, double percentile)
+        {
+            int index = (int)Math.Ceiling(percentile / 100.0 * sorted.Count) - 1;
+            return sorted[Math.Max(0, Math.Min(index, sorted.Count - 1))];
+        }
+    }
+}